@@ -0,0 +1,107 @@
+#ifndef GGHDELTAR_H
+#define GGHDELTAR_H
+
+// ============================================================================
+// Δφ / ΔR kernels shared by the analysis macros
+//
+// deltaPhi wraps into (-π, π] with two compare-and-select steps instead of
+// while loops (branch-free). Valid for |φ1 - φ2| <= 3π, i.e. any pair of
+// angles already in [-π, π]. Cuts on ΔR should compare deltaR2 with the
+// squared threshold rather than take the sqrt.
+// ============================================================================
+
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace ggH {
+
+constexpr double kPi    = 3.14159265358979323846;
+constexpr double kTwoPi = 2.0 * kPi;
+
+inline float deltaPhi(float phi1, float phi2)
+{
+   const float pi    = float(kPi);
+   const float twoPi = float(kTwoPi);
+
+   // both candidates computed unconditionally so the selects if-convert
+   float d  = phi1 - phi2;
+   float dm = d - twoPi;
+   float dp = d + twoPi;
+   d = (d >  pi) ? dm : d;
+   d = (d <= -pi) ? dp : d;
+   return d;
+}
+
+inline double deltaPhi(double phi1, double phi2)
+{
+   double d  = phi1 - phi2;
+   double dm = d - kTwoPi;
+   double dp = d + kTwoPi;
+   d = (d >  kPi) ? dm : d;
+   d = (d <= -kPi) ? dp : d;
+   return d;
+}
+
+inline float deltaR2(float eta1, float phi1, float eta2, float phi2)
+{
+   float dEta = eta1 - eta2;
+   float dPhi = deltaPhi(phi1, phi2);
+   return dEta*dEta + dPhi*dPhi;
+}
+
+inline float deltaR(float eta1, float phi1, float eta2, float phi2)
+{
+   return std::sqrt(deltaR2(eta1, phi1, eta2, phi2));
+}
+
+// ----------------------------------------------------------------------
+// ΔR² of every (a, b) pair in one pass: out[i*nB + j] = ΔR²(a_i, b_j).
+// Inputs are contiguous eta/phi arrays (structure-of-arrays). With SSE2
+// four a's (jets) are handled per instruction against each b (lepton);
+// the Δφ wrap uses compare masks, same arithmetic as deltaPhi().
+// ----------------------------------------------------------------------
+inline void deltaR2Matrix(const float *etaA, const float *phiA, int nA,
+                          const float *etaB, const float *phiB, int nB,
+                          float *out)
+{
+   int i = 0;
+
+#if defined(__SSE2__)
+   const __m128 pi    = _mm_set1_ps(float(kPi));
+   const __m128 mPi   = _mm_set1_ps(-float(kPi));
+   const __m128 twoPi = _mm_set1_ps(float(kTwoPi));
+
+   for (; i + 4 <= nA; i += 4) {
+      const __m128 eta = _mm_loadu_ps(etaA + i);
+      const __m128 phi = _mm_loadu_ps(phiA + i);
+
+      for (int j = 0; j < nB; ++j) {
+         __m128 dEta = _mm_sub_ps(eta, _mm_set1_ps(etaB[j]));
+         __m128 dPhi = _mm_sub_ps(phi, _mm_set1_ps(phiB[j]));
+         dPhi = _mm_sub_ps(dPhi, _mm_and_ps(_mm_cmpgt_ps(dPhi, pi),  twoPi));
+         dPhi = _mm_add_ps(dPhi, _mm_and_ps(_mm_cmple_ps(dPhi, mPi), twoPi));
+
+         float r[4];
+         _mm_storeu_ps(r, _mm_add_ps(_mm_mul_ps(dEta, dEta), _mm_mul_ps(dPhi, dPhi)));
+         out[(i+0)*nB + j] = r[0];
+         out[(i+1)*nB + j] = r[1];
+         out[(i+2)*nB + j] = r[2];
+         out[(i+3)*nB + j] = r[3];
+      }
+   }
+#endif
+
+   // remaining rows (or everything without SSE2)
+   for (; i < nA; ++i) {
+      for (int j = 0; j < nB; ++j) {
+         out[i*nB + j] = deltaR2(etaA[i], phiA[i], etaB[j], phiB[j]);
+      }
+   }
+}
+
+} // namespace ggH
+
+#endif // GGHDELTAR_H